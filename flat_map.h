@@ -0,0 +1,331 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_FLAT_MAP_H_
+#define OOP_ASSIGNMENTS_VECTOR_FLAT_MAP_H_
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include "vector.h"
+
+// Index of the first element of the sorted range [data, data + size) that is not
+// less than `key`. The loop body has no branch on the comparison result, so the
+// probe sequence does not depend on branch prediction.
+template <typename Key, typename Compare>
+[[nodiscard]] size_t BranchlessLowerBound(const Key* data, size_t size, const Key& key, const Compare& cmp) {
+  if (size == 0) {
+    return 0;
+  }
+  const Key* base = data;
+  while (size > 1) {
+    size_t half = size / 2;
+    base = cmp(base[half - 1], key) ? base + half : base;
+    size -= half;
+  }
+  return static_cast<size_t>(base - data) + (cmp(*base, key) ? 1 : 0);
+}
+
+// Sorted associative container keeping keys and values in two parallel Vectors.
+// Duplicate keys keep the first inserted value, as std::map::insert does.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap {
+ public:
+  using KeyType = Key;
+  using MappedType = Value;
+  using SizeType = size_t;
+
+  FlatMap() = default;
+
+  explicit FlatMap(const Compare& cmp) : cmp_(cmp) {
+  }
+
+  FlatMap(const std::initializer_list<std::pair<Key, Value>>& init_lst, const Compare& cmp = Compare())
+      : cmp_(cmp) {
+    InsertRange(init_lst.begin(), init_lst.end());
+  }
+
+  template <typename InputIterator>
+  FlatMap(InputIterator begin, InputIterator end, const Compare& cmp = Compare()) : cmp_(cmp) {
+    InsertRange(begin, end);
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return keys_.Size();
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return keys_.Empty();
+  }
+
+  void Clear() {
+    keys_.Clear();
+    values_.Clear();
+  }
+
+  void Reserve(size_t capacity) {
+    keys_.Reserve(capacity);
+    values_.Reserve(capacity);
+  }
+
+  [[nodiscard]] const Vector<Key>& Keys() const noexcept {
+    return keys_;
+  }
+
+  [[nodiscard]] const Vector<Value>& Values() const noexcept {
+    return values_;
+  }
+
+  // Values in key order, Size() of them. Only the elements are mutable; the
+  // Vector itself stays const so it cannot fall out of step with Keys().
+  [[nodiscard]] Value* MutableValues() noexcept {
+    return values_.Data();
+  }
+
+  [[nodiscard]] SizeType LowerBound(const Key& key) const {
+    return BranchlessLowerBound(keys_.Data(), keys_.Size(), key, cmp_);
+  }
+
+  [[nodiscard]] bool Contains(const Key& key) const {
+    return Find(key) != nullptr;
+  }
+
+  [[nodiscard]] const Value* Find(const Key& key) const {
+    size_t idx = LowerBound(key);
+    if (idx == keys_.Size() || cmp_(key, keys_[idx])) {
+      return nullptr;
+    }
+    return values_.Data() + idx;
+  }
+
+  [[nodiscard]] Value* Find(const Key& key) {
+    return const_cast<Value*>(std::as_const(*this).Find(key));
+  }
+
+  [[nodiscard]] const Value& At(const Key& key) const {
+    const Value* value = Find(key);
+    if (value == nullptr) {
+      throw std::out_of_range("");
+    }
+    return *value;
+  }
+
+  [[nodiscard]] Value& At(const Key& key) {
+    return const_cast<Value&>(std::as_const(*this).At(key));
+  }
+
+  Value& operator[](const Key& key) {
+    size_t idx = LowerBound(key);
+    if (idx == keys_.Size() || cmp_(key, keys_[idx])) {
+      InsertAt(idx, key, Value());
+    }
+    return values_[idx];
+  }
+
+  // Returns false and leaves the stored value untouched if `key` is present.
+  bool Insert(const Key& key, const Value& value) {
+    size_t idx = LowerBound(key);
+    if (idx != keys_.Size() && !cmp_(key, keys_[idx])) {
+      return false;
+    }
+    InsertAt(idx, key, value);
+    return true;
+  }
+
+  bool InsertOrAssign(const Key& key, const Value& value) {
+    size_t idx = LowerBound(key);
+    if (idx != keys_.Size() && !cmp_(key, keys_[idx])) {
+      values_[idx] = value;
+      return false;
+    }
+    InsertAt(idx, key, value);
+    return true;
+  }
+
+  bool Erase(const Key& key) {
+    size_t idx = LowerBound(key);
+    if (idx == keys_.Size() || cmp_(key, keys_[idx])) {
+      return false;
+    }
+    std::rotate(keys_.begin() + idx, keys_.begin() + idx + 1, keys_.end());
+    std::rotate(values_.begin() + idx, values_.begin() + idx + 1, values_.end());
+    keys_.PopBack();
+    values_.PopBack();
+    return true;
+  }
+
+  // Inserts a batch of key/value pairs: the batch is sorted and deduplicated
+  // once and then merged with the stored run in a single linear pass.
+  template <typename InputIterator>
+  void InsertRange(InputIterator begin, InputIterator end) {
+    Vector<std::pair<Key, Value>> run;
+    for (; begin != end; ++begin) {
+      run.PushBack(*begin);
+    }
+    if (run.Empty()) {
+      return;
+    }
+    std::stable_sort(run.begin(), run.end(),
+                     [this](const auto& lhs, const auto& rhs) { return cmp_(lhs.first, rhs.first); });
+    Vector<Key> keys;
+    Vector<Value> values;
+    keys.Reserve(keys_.Size() + run.Size());
+    values.Reserve(keys_.Size() + run.Size());
+    size_t i = 0;
+    size_t j = 0;
+    while (i < keys_.Size() || j < run.Size()) {
+      if (j == run.Size() || (i < keys_.Size() && !cmp_(run[j].first, keys_[i]))) {
+        if (j < run.Size() && !cmp_(keys_[i], run[j].first)) {
+          ++j;
+          continue;
+        }
+        keys.PushBack(std::move(keys_[i]));
+        values.PushBack(std::move(values_[i]));
+        ++i;
+        continue;
+      }
+      if (keys.Empty() || cmp_(keys.Back(), run[j].first)) {
+        keys.PushBack(std::move(run[j].first));
+        values.PushBack(std::move(run[j].second));
+      }
+      ++j;
+    }
+    keys_.Swap(keys);
+    values_.Swap(values);
+  }
+
+ private:
+  void InsertAt(size_t idx, const Key& key, const Value& value) {
+    keys_.PushBack(key);
+    try {
+      values_.PushBack(value);
+    } catch (...) {
+      keys_.PopBack();
+      throw;
+    }
+    std::rotate(keys_.begin() + idx, keys_.end() - 1, keys_.end());
+    std::rotate(values_.begin() + idx, values_.end() - 1, values_.end());
+  }
+
+ private:
+  Vector<Key> keys_;
+  Vector<Value> values_;
+  Compare cmp_;
+};
+
+// Sorted set of unique keys stored contiguously in a Vector.
+template <typename Key, typename Compare = std::less<Key>>
+class FlatSet {
+ public:
+  using KeyType = Key;
+  using SizeType = size_t;
+  using ConstIterator = typename Vector<Key>::ConstIterator;
+
+  FlatSet() = default;
+
+  explicit FlatSet(const Compare& cmp) : cmp_(cmp) {
+  }
+
+  FlatSet(const std::initializer_list<Key>& init_lst, const Compare& cmp = Compare()) : cmp_(cmp) {
+    InsertRange(init_lst.begin(), init_lst.end());
+  }
+
+  template <typename InputIterator>
+  FlatSet(InputIterator begin, InputIterator end, const Compare& cmp = Compare()) : cmp_(cmp) {
+    InsertRange(begin, end);
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return keys_.Size();
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return keys_.Empty();
+  }
+
+  void Clear() {
+    keys_.Clear();
+  }
+
+  void Reserve(size_t capacity) {
+    keys_.Reserve(capacity);
+  }
+
+  [[nodiscard]] const Vector<Key>& Keys() const noexcept {
+    return keys_;
+  }
+
+  [[nodiscard]] SizeType LowerBound(const Key& key) const {
+    return BranchlessLowerBound(keys_.Data(), keys_.Size(), key, cmp_);
+  }
+
+  [[nodiscard]] bool Contains(const Key& key) const {
+    size_t idx = LowerBound(key);
+    return idx != keys_.Size() && !cmp_(key, keys_[idx]);
+  }
+
+  bool Insert(const Key& key) {
+    size_t idx = LowerBound(key);
+    if (idx != keys_.Size() && !cmp_(key, keys_[idx])) {
+      return false;
+    }
+    keys_.PushBack(key);
+    std::rotate(keys_.begin() + idx, keys_.end() - 1, keys_.end());
+    return true;
+  }
+
+  bool Erase(const Key& key) {
+    size_t idx = LowerBound(key);
+    if (idx == keys_.Size() || cmp_(key, keys_[idx])) {
+      return false;
+    }
+    std::rotate(keys_.begin() + idx, keys_.begin() + idx + 1, keys_.end());
+    keys_.PopBack();
+    return true;
+  }
+
+  // Sorts and deduplicates the batch once, then merges it with the stored keys.
+  template <typename InputIterator>
+  void InsertRange(InputIterator begin, InputIterator end) {
+    Vector<Key> run;
+    for (; begin != end; ++begin) {
+      run.PushBack(*begin);
+    }
+    if (run.Empty()) {
+      return;
+    }
+    std::sort(run.begin(), run.end(), cmp_);
+    Vector<Key> keys;
+    keys.Reserve(keys_.Size() + run.Size());
+    auto equal = [this](const Key& lhs, const Key& rhs) { return !cmp_(lhs, rhs) && !cmp_(rhs, lhs); };
+    auto run_end = std::unique(run.begin(), run.end(), equal);
+    size_t i = 0;
+    auto j = run.begin();
+    while (i < keys_.Size() || j != run_end) {
+      if (j == run_end || (i < keys_.Size() && !cmp_(*j, keys_[i]))) {
+        if (j != run_end && !cmp_(keys_[i], *j)) {
+          ++j;
+        }
+        keys.PushBack(std::move(keys_[i]));
+        ++i;
+      } else {
+        keys.PushBack(std::move(*j));
+        ++j;
+      }
+    }
+    keys_.Swap(keys);
+  }
+
+  [[nodiscard]] ConstIterator begin() const noexcept {  // NOLINT
+    return keys_.begin();
+  }
+
+  [[nodiscard]] ConstIterator end() const noexcept {  // NOLINT
+    return keys_.end();
+  }
+
+ private:
+  Vector<Key> keys_;
+  Compare cmp_;
+};
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_FLAT_MAP_H_
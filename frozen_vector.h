@@ -0,0 +1,251 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_FROZEN_VECTOR_H_
+#define OOP_ASSIGNMENTS_VECTOR_FROZEN_VECTOR_H_
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+#include "vector.h"
+
+// Immutable compressed form of a sorted integer Vector. Values are split into
+// blocks of kBlockSize; each block keeps its first value in a skip index and
+// stores the remaining deltas bit-packed with the smallest width that fits them.
+template <typename T>
+class FrozenVector {
+  static_assert(std::is_integral_v<T>, "FrozenVector requires an integral value type");
+
+ public:
+  using ValueType = T;
+  using SizeType = size_t;
+
+  static constexpr size_t kBlockSize = 128;
+
+ private:
+  using DeltaType = std::make_unsigned_t<T>;
+  static constexpr size_t kWordBits = 64;
+
+ public:
+  FrozenVector() noexcept = default;
+
+  [[nodiscard]] static FrozenVector Freeze(const Vector<T>& values) {
+    for (size_t i = 1; i < values.Size(); ++i) {
+      if (values[i] < values[i - 1]) {
+        throw std::invalid_argument("FrozenVector::Freeze: values are not sorted");
+      }
+    }
+    FrozenVector frozen;
+    frozen.size_ = values.Size();
+    size_t blocks = (values.Size() + kBlockSize - 1) / kBlockSize;
+    frozen.block_first_.Reserve(blocks);
+    frozen.block_width_.Reserve(blocks);
+    frozen.block_offset_.Reserve(blocks + 1);
+    // Widths are found in a first pass so `words_` is allocated once at its
+    // final size instead of carrying doubling slack.
+    size_t total_words = 0;
+    for (size_t begin = 0; begin < values.Size(); begin += kBlockSize) {
+      size_t length = std::min(kBlockSize, values.Size() - begin);
+      uint8_t width = DeltaWidth(values.Data() + begin, length);
+      frozen.block_width_.PushBack(width);
+      total_words += PackedWords(length, width);
+    }
+    frozen.words_.Reserve(total_words + 1);
+    for (size_t block = 0; block < blocks; ++block) {
+      size_t begin = block * kBlockSize;
+      size_t length = std::min(kBlockSize, values.Size() - begin);
+      frozen.EncodeBlock(values.Data() + begin, length, frozen.block_width_[block]);
+    }
+    frozen.block_offset_.PushBack(frozen.words_.Size());
+    // One trailing word lets the unpack loop read word + 1 without a bounds check.
+    frozen.words_.PushBack(0);
+    return frozen;
+  }
+
+  [[nodiscard]] Vector<T> Thaw() const {
+    Vector<T> values(size_);
+    for (size_t block = 0; block < BlockCount(); ++block) {
+      DecodeBlock(block, values.Data() + block * kBlockSize);
+    }
+    return values;
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] SizeType BlockCount() const noexcept {
+    return block_first_.Size();
+  }
+
+  [[nodiscard]] SizeType BlockLength(size_t block) const noexcept {
+    return std::min(kBlockSize, size_ - block * kBlockSize);
+  }
+
+  [[nodiscard]] SizeType MemoryUsage() const noexcept {
+    return block_first_.Capacity() * sizeof(T) + block_width_.Capacity() * sizeof(uint8_t) +
+           block_offset_.Capacity() * sizeof(size_t) + words_.Capacity() * sizeof(uint64_t);
+  }
+
+  // Writes the values of block `block` to `out`, which must have room for
+  // BlockLength(block) elements, and returns the number written.
+  size_t DecodeBlock(size_t block, T* out) const noexcept {
+    size_t length = BlockLength(block);
+    UnpackDeltas(block, length, out);
+    DeltaType running = static_cast<DeltaType>(block_first_[block]);
+    out[0] = block_first_[block];
+    for (size_t i = 1; i < length; ++i) {
+      running += static_cast<DeltaType>(out[i]);
+      out[i] = static_cast<T>(running);
+    }
+    return length;
+  }
+
+  [[nodiscard]] T operator[](size_t idx) const noexcept {
+    size_t block = idx / kBlockSize;
+    size_t in_block = idx % kBlockSize;
+    DeltaType value = static_cast<DeltaType>(block_first_[block]);
+    uint8_t width = block_width_[block];
+    if (width == 0) {
+      return static_cast<T>(value);
+    }
+    const uint64_t* words = words_.Data() + block_offset_[block];
+    for (size_t i = 0; i < in_block; ++i) {
+      value += static_cast<DeltaType>(ReadBits(words, i * width, width));
+    }
+    return static_cast<T>(value);
+  }
+
+  [[nodiscard]] T At(size_t idx) const {
+    if (idx >= size_) {
+      throw std::out_of_range("");
+    }
+    return (*this)[idx];
+  }
+
+  [[nodiscard]] T Front() const noexcept {
+    return block_first_[0];
+  }
+
+  [[nodiscard]] T Back() const noexcept {
+    return (*this)[size_ - 1];
+  }
+
+  // Index of the first element not less than `value`, or Size() if there is none.
+  [[nodiscard]] SizeType LowerBound(const T& value) const noexcept {
+    if (size_ == 0) {
+      return 0;
+    }
+    auto first = block_first_.begin();
+    auto it = std::lower_bound(first, block_first_.end(), value);
+    if (it == first) {
+      return 0;
+    }
+    size_t block = static_cast<size_t>(it - first) - 1;
+    T decoded[kBlockSize];
+    size_t length = DecodeBlock(block, decoded);
+    size_t pos = static_cast<size_t>(std::lower_bound(decoded, decoded + length, value) - decoded);
+    return block * kBlockSize + pos;
+  }
+
+  [[nodiscard]] bool Contains(const T& value) const noexcept {
+    size_t idx = LowerBound(value);
+    return idx < size_ && (*this)[idx] == value;
+  }
+
+  // Calls `func` on every value in order, decoding one block at a time.
+  template <typename Func>
+  void ForEach(Func&& func) const {
+    T decoded[kBlockSize];
+    for (size_t block = 0; block < BlockCount(); ++block) {
+      size_t length = DecodeBlock(block, decoded);
+      for (size_t i = 0; i < length; ++i) {
+        func(decoded[i]);
+      }
+    }
+  }
+
+ private:
+  static uint8_t BitWidth(DeltaType value) noexcept {
+    uint8_t width = 0;
+    while (value != 0) {
+      ++width;
+      value >>= 1;
+    }
+    return width;
+  }
+
+  static uint64_t ReadBits(const uint64_t* words, size_t bit_pos, uint8_t width) noexcept {
+    size_t word = bit_pos / kWordBits;
+    size_t shift = bit_pos % kWordBits;
+    uint64_t low = words[word] >> shift;
+    // Split shift keeps the high part well defined when shift == 0.
+    uint64_t high = (words[word + 1] << 1) << (kWordBits - 1 - shift);
+    uint64_t mask = width == kWordBits ? ~uint64_t{0} : (uint64_t{1} << width) - 1;
+    return (low | high) & mask;
+  }
+
+  static uint8_t DeltaWidth(const T* values, size_t length) noexcept {
+    DeltaType max_delta = 0;
+    for (size_t i = 1; i < length; ++i) {
+      max_delta = std::max(max_delta, static_cast<DeltaType>(static_cast<DeltaType>(values[i]) -
+                                                             static_cast<DeltaType>(values[i - 1])));
+    }
+    return BitWidth(max_delta);
+  }
+
+  static size_t PackedWords(size_t length, uint8_t width) noexcept {
+    return ((length - 1) * width + kWordBits - 1) / kWordBits;
+  }
+
+  void EncodeBlock(const T* values, size_t length, uint8_t width) {
+    block_first_.PushBack(values[0]);
+    block_offset_.PushBack(words_.Size());
+    if (width == 0) {
+      return;
+    }
+    size_t words = PackedWords(length, width);
+    size_t base = words_.Size();
+    for (size_t i = 0; i < words; ++i) {
+      words_.PushBack(0);
+    }
+    uint64_t* out = words_.Data() + base;
+    for (size_t i = 1; i < length; ++i) {
+      uint64_t delta = static_cast<DeltaType>(static_cast<DeltaType>(values[i]) -
+                                              static_cast<DeltaType>(values[i - 1]));
+      size_t bit_pos = (i - 1) * width;
+      size_t word = bit_pos / kWordBits;
+      size_t shift = bit_pos % kWordBits;
+      out[word] |= delta << shift;
+      if (shift + width > kWordBits) {
+        out[word + 1] |= delta >> (kWordBits - shift);
+      }
+    }
+  }
+
+  // Unpacks the deltas of a block into out[1..length). The loop has a fixed
+  // stride and no data-dependent branches, so compilers vectorize it.
+  void UnpackDeltas(size_t block, size_t length, T* out) const noexcept {
+    uint8_t width = block_width_[block];
+    if (width == 0) {
+      for (size_t i = 1; i < length; ++i) {
+        out[i] = 0;
+      }
+      return;
+    }
+    const uint64_t* words = words_.Data() + block_offset_[block];
+    for (size_t i = 1; i < length; ++i) {
+      out[i] = static_cast<T>(ReadBits(words, (i - 1) * width, width));
+    }
+  }
+
+ private:
+  Vector<T> block_first_;
+  Vector<uint8_t> block_width_;
+  Vector<size_t> block_offset_;
+  Vector<uint64_t> words_;
+  size_t size_{0};
+};
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_FROZEN_VECTOR_H_
@@ -0,0 +1,164 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_MEMORY_BUDGET_H_
+#define OOP_ASSIGNMENTS_VECTOR_MEMORY_BUDGET_H_
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <utility>
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+#include "vector.h"
+
+// Process-wide registry of Vectors that may give memory back. When resident
+// memory exceeds the configured limit, Poll() asks every registered Vector to
+// TrimSlack(). The registry does not synchronize access to the Vectors
+// themselves, so Poll() and TrimAll() must run where those Vectors may be mutated.
+class MemoryBudget {
+ private:
+  using TrimFunction = size_t (*)(void*);
+
+  struct Entry {
+    size_t id{0};
+    void* owner{nullptr};
+    TrimFunction trim{nullptr};
+  };
+
+ public:
+  // Keeps a Vector registered for as long as it is alive. The registry holds the
+  // Vector's address, so the Vector object must outlive its registration and
+  // must not be relocated while registered, e.g. as an element of a container
+  // that reallocates. Moving elements out of it is fine.
+  class Registration {
+   public:
+    Registration() noexcept = default;
+
+    Registration(const Registration&) = delete;
+    Registration& operator=(const Registration&) = delete;
+
+    Registration(Registration&& other) noexcept
+        : budget_(std::exchange(other.budget_, nullptr)), id_(std::exchange(other.id_, 0)) {
+    }
+
+    Registration& operator=(Registration&& other) noexcept {
+      if (this != &other) {
+        Reset();
+        budget_ = std::exchange(other.budget_, nullptr);
+        id_ = std::exchange(other.id_, 0);
+      }
+      return *this;
+    }
+
+    ~Registration() {
+      Reset();
+    }
+
+    void Reset() noexcept {
+      if (budget_ != nullptr) {
+        budget_->Unregister(id_);
+        budget_ = nullptr;
+      }
+    }
+
+   private:
+    friend class MemoryBudget;
+
+    Registration(MemoryBudget* budget, size_t id) noexcept : budget_(budget), id_(id) {
+    }
+
+    MemoryBudget* budget_{nullptr};
+    size_t id_{0};
+  };
+
+  MemoryBudget() = default;
+
+  MemoryBudget(const MemoryBudget&) = delete;
+  MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+  [[nodiscard]] static MemoryBudget& Instance() {
+    static MemoryBudget instance;
+    return instance;
+  }
+
+  // Poll() and TrimAll() call TrimSlack() on `vector` without synchronizing
+  // with its owner, so they must not run while another thread may be using it;
+  // polling from a separate monitor thread is a data race.
+  template <typename T>
+  [[nodiscard]] Registration Register(Vector<T>& vector) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t id = ++last_id_;
+    entries_.PushBack(Entry{id, &vector, [](void* owner) { return static_cast<Vector<T>*>(owner)->TrimSlack(); }});
+    return Registration(this, id);
+  }
+
+  // Resident set size limit in bytes; 0 disables Poll().
+  void SetLimit(size_t bytes) noexcept {
+    limit_.store(bytes, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] size_t Limit() const noexcept {
+    return limit_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] size_t RegisteredCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.Size();
+  }
+
+  // Current resident set size in bytes, or 0 where it cannot be measured.
+  [[nodiscard]] static size_t ResidentBytes() {
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (!(statm >> total_pages >> resident_pages)) {
+      return 0;
+    }
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+  }
+
+  // Trims every registered Vector and returns the number of bytes released.
+  // A Vector that fails to reallocate keeps its buffer.
+  size_t TrimAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t released = 0;
+    for (size_t i = 0; i < entries_.Size(); ++i) {
+      try {
+        released += entries_[i].trim(entries_[i].owner);
+      } catch (...) {
+      }
+    }
+    return released;
+  }
+
+  // Trims only when resident memory exceeds the limit.
+  size_t Poll() {
+    size_t limit = Limit();
+    if (limit == 0 || ResidentBytes() <= limit) {
+      return 0;
+    }
+    return TrimAll();
+  }
+
+ private:
+  void Unregister(size_t id) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < entries_.Size(); ++i) {
+      if (entries_[i].id == id) {
+        std::swap(entries_[i], entries_.Back());
+        entries_.PopBack();
+        return;
+      }
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  Vector<Entry> entries_;
+  size_t last_id_{0};
+  std::atomic<size_t> limit_{0};
+};
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_MEMORY_BUDGET_H_
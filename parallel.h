@@ -0,0 +1,358 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_PARALLEL_H_
+#define OOP_ASSIGNMENTS_VECTOR_PARALLEL_H_
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "vector.h"
+
+struct ParallelOptions {
+  // Elements per task, rounded up to whole cache lines; 0 picks ~64 KiB of input.
+  size_t grain{0};
+  // Inputs shorter than this run serially on the calling thread.
+  size_t serial_cutoff{size_t{1} << 15};
+  // Combine partial results in index order. Chunk boundaries depend only on the
+  // input size and grain, so results do not vary with thread count or scheduling.
+  bool deterministic{true};
+};
+
+// Thread pool with one task deque per worker. Workers take tasks from the front
+// of their own deque and steal from the back of the others; the thread calling
+// Run() steals as well until its job completes.
+class WorkStealingPool {
+ public:
+  static constexpr size_t kCacheLineSize = 64;
+
+ private:
+  struct Job {
+    void (*invoke)(void*, size_t){nullptr};
+    void* body{nullptr};
+    std::atomic<size_t> pending{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+  };
+
+  struct Task {
+    Job* job{nullptr};
+    size_t index{0};
+  };
+
+  struct alignas(kCacheLineSize) Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+ public:
+  explicit WorkStealingPool(size_t threads = std::thread::hardware_concurrency())
+      : worker_count_(threads > 1 ? threads - 1 : 0)
+      , queues_(std::make_unique<Queue[]>(std::max<size_t>(worker_count_, 1))) {
+    workers_.Reserve(worker_count_);
+    for (size_t i = 0; i < worker_count_; ++i) {
+      workers_.PushBack(std::thread([this, i] { WorkerLoop(i); }));
+    }
+  }
+
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+  ~WorkStealingPool() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  [[nodiscard]] static WorkStealingPool& Instance() {
+    static WorkStealingPool instance;
+    return instance;
+  }
+
+  // Worker threads plus the calling thread.
+  [[nodiscard]] size_t Concurrency() const noexcept {
+    return worker_count_ + 1;
+  }
+
+  // Calls body(i) for every i in [0, tasks) and returns once all calls have
+  // finished, rethrowing the first exception raised by any of them. Calls made
+  // from inside a pool task run serially instead of queueing behind themselves.
+  template <typename Func>
+  void Run(size_t tasks, Func&& body) {
+    if (worker_count_ == 0 || tasks <= 1 || in_worker) {
+      for (size_t i = 0; i < tasks; ++i) {
+        body(i);
+      }
+      return;
+    }
+    Job job;
+    job.invoke = [](void* callable, size_t index) { (*static_cast<std::remove_reference_t<Func>*>(callable))(index); };
+    job.body = const_cast<void*>(static_cast<const volatile void*>(std::addressof(body)));
+    job.pending.store(tasks, std::memory_order_relaxed);
+    size_t queues = worker_count_;
+    for (size_t q = 0; q < queues; ++q) {
+      std::lock_guard<std::mutex> lock(queues_[q].mutex);
+      for (size_t i = q * tasks / queues; i < (q + 1) * tasks / queues; ++i) {
+        queues_[q].tasks.push_back(Task{&job, i});
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      queued_.fetch_add(tasks, std::memory_order_relaxed);
+    }
+    wake_.notify_all();
+    while (job.pending.load(std::memory_order_acquire) != 0) {
+      Task task;
+      if (Steal(0, task)) {
+        Execute(task);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    if (job.error) {
+      std::rethrow_exception(job.error);
+    }
+  }
+
+ private:
+  static void Execute(const Task& task) noexcept {
+    Job* job = task.job;
+    try {
+      job->invoke(job->body, task.index);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(job->error_mutex);
+      if (!job->error) {
+        job->error = std::current_exception();
+      }
+    }
+    job->pending.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  bool PopLocal(size_t self, Task& task) {
+    std::lock_guard<std::mutex> lock(queues_[self].mutex);
+    if (queues_[self].tasks.empty()) {
+      return false;
+    }
+    task = queues_[self].tasks.front();
+    queues_[self].tasks.pop_front();
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool Steal(size_t start, Task& task) {
+    size_t queues = worker_count_;
+    for (size_t k = 0; k < queues; ++k) {
+      Queue& victim = queues_[(start + k) % queues];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task = victim.tasks.back();
+        victim.tasks.pop_back();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void WorkerLoop(size_t self) {
+    in_worker = true;
+    while (true) {
+      Task task;
+      if (PopLocal(self, task) || Steal(self + 1, task)) {
+        Execute(task);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      wake_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_relaxed) != 0; });
+      if (stop_ && queued_.load(std::memory_order_relaxed) == 0) {
+        return;
+      }
+    }
+  }
+
+ private:
+  static inline thread_local bool in_worker = false;
+
+  const size_t worker_count_;
+  std::unique_ptr<Queue[]> queues_;
+  Vector<std::thread> workers_;
+  std::atomic<size_t> queued_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stop_{false};
+};
+
+[[nodiscard]] inline size_t ParallelGrain(size_t element_size, const ParallelOptions& options) noexcept {
+  constexpr size_t kDefaultGrainBytes = size_t{64} << 10;
+  size_t line = std::max<size_t>(WorkStealingPool::kCacheLineSize / element_size, 1);
+  size_t grain = options.grain != 0 ? options.grain : std::max<size_t>(kDefaultGrainBytes / element_size, 1);
+  return (grain + line - 1) / line * line;
+}
+
+// Splits [0, size) into grain-sized chunks and calls body(chunk, begin, end)
+// for each, serially when the input is below the cutoff. Returns the chunk count.
+template <typename Func>
+size_t ParallelChunks(size_t size, size_t element_size, const ParallelOptions& options, Func&& body) {
+  if (size == 0) {
+    return 0;
+  }
+  size_t grain = ParallelGrain(element_size, options);
+  size_t chunks = (size + grain - 1) / grain;
+  if (size < options.serial_cutoff) {
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+      body(chunk, chunk * grain, std::min(size, (chunk + 1) * grain));
+    }
+    return chunks;
+  }
+  WorkStealingPool::Instance().Run(chunks, [&](size_t chunk) {
+    body(chunk, chunk * grain, std::min(size, (chunk + 1) * grain));
+  });
+  return chunks;
+}
+
+template <typename T, typename Func>
+void ParallelForEach(Vector<T>& values, Func func, const ParallelOptions& options = ParallelOptions()) {
+  ParallelChunks(values.Size(), sizeof(T), options, [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      func(values[i]);
+    }
+  });
+}
+
+// Resizes `dst` to the size of `src` and stores func(src[i]) into dst[i].
+template <typename T, typename U, typename Func>
+void Transform(const Vector<T>& src, Vector<U>& dst, Func func, const ParallelOptions& options = ParallelOptions()) {
+  dst.Resize(src.Size());
+  ParallelChunks(src.Size(), std::max(sizeof(T), sizeof(U)), options, [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      dst[i] = func(src[i]);
+    }
+  });
+}
+
+// `reduce` must be associative; with options.deterministic == false partial
+// results are also combined in completion order, so it must be commutative too.
+template <typename T, typename R, typename ReduceOp, typename TransformOp>
+[[nodiscard]] R TransformReduce(const Vector<T>& values, R init, ReduceOp reduce, TransformOp transform,
+                                const ParallelOptions& options = ParallelOptions()) {
+  auto reduce_chunk = [&](size_t begin, size_t end) {
+    R acc = transform(values[begin]);
+    for (size_t i = begin + 1; i < end; ++i) {
+      acc = reduce(std::move(acc), transform(values[i]));
+    }
+    return acc;
+  };
+  if (values.Empty()) {
+    return init;
+  }
+  if (values.Size() < options.serial_cutoff) {
+    return reduce(std::move(init), reduce_chunk(0, values.Size()));
+  }
+  size_t grain = ParallelGrain(sizeof(T), options);
+  size_t chunks = (values.Size() + grain - 1) / grain;
+  if (options.deterministic) {
+    auto partials = std::make_unique<std::optional<R>[]>(chunks);
+    ParallelChunks(values.Size(), sizeof(T), options, [&](size_t chunk, size_t begin, size_t end) {
+      partials[chunk].emplace(reduce_chunk(begin, end));
+    });
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+      init = reduce(std::move(init), std::move(*partials[chunk]));
+    }
+    return init;
+  }
+  std::mutex mutex;
+  std::optional<R> total;
+  ParallelChunks(values.Size(), sizeof(T), options, [&](size_t, size_t begin, size_t end) {
+    R partial = reduce_chunk(begin, end);
+    std::lock_guard<std::mutex> lock(mutex);
+    total = total ? reduce(std::move(*total), std::move(partial)) : std::move(partial);
+  });
+  return reduce(std::move(init), std::move(*total));
+}
+
+template <typename T, typename R, typename ReduceOp>
+[[nodiscard]] R Reduce(const Vector<T>& values, R init, ReduceOp reduce, const ParallelOptions& options = ParallelOptions()) {
+  return TransformReduce(values, std::move(init), reduce, [](const T& value) -> const T& { return value; }, options);
+}
+
+template <typename T>
+[[nodiscard]] T Reduce(const Vector<T>& values, const ParallelOptions& options = ParallelOptions()) {
+  return Reduce(values, T(), std::plus<>(), options);
+}
+
+// dst[i] = src[0] op ... op src[i]. Each chunk is scanned twice: once for its
+// total and once, after the totals are combined in order, with its offset.
+template <typename T, typename BinaryOp>
+void InclusiveScan(const Vector<T>& src, Vector<T>& dst, BinaryOp op, const ParallelOptions& options = ParallelOptions()) {
+  dst.Resize(src.Size());
+  if (src.Size() < options.serial_cutoff) {
+    for (size_t i = 0; i < src.Size(); ++i) {
+      dst[i] = i == 0 ? src[0] : op(dst[i - 1], src[i]);
+    }
+    return;
+  }
+  size_t grain = ParallelGrain(sizeof(T), options);
+  Vector<T> offsets((src.Size() + grain - 1) / grain);
+  ParallelChunks(src.Size(), sizeof(T), options, [&](size_t chunk, size_t begin, size_t end) {
+    T acc = src[begin];
+    for (size_t i = begin + 1; i < end; ++i) {
+      acc = op(std::move(acc), src[i]);
+    }
+    offsets[chunk] = std::move(acc);
+  });
+  for (size_t chunk = 1; chunk < offsets.Size(); ++chunk) {
+    offsets[chunk] = op(offsets[chunk - 1], offsets[chunk]);
+  }
+  ParallelChunks(src.Size(), sizeof(T), options, [&](size_t chunk, size_t begin, size_t end) {
+    dst[begin] = chunk == 0 ? src[begin] : op(offsets[chunk - 1], src[begin]);
+    for (size_t i = begin + 1; i < end; ++i) {
+      dst[i] = op(dst[i - 1], src[i]);
+    }
+  });
+}
+
+template <typename T>
+void InclusiveScan(const Vector<T>& src, Vector<T>& dst, const ParallelOptions& options = ParallelOptions()) {
+  InclusiveScan(src, dst, std::plus<>(), options);
+}
+
+// Replaces the contents of `dst` with the elements of `src` matching `pred`,
+// keeping their order. Each predicate result is computed exactly once.
+template <typename T, typename Pred>
+void CopyIf(const Vector<T>& src, Vector<T>& dst, Pred pred, const ParallelOptions& options = ParallelOptions()) {
+  size_t grain = ParallelGrain(sizeof(T), options);
+  Vector<unsigned char> keep(src.Size());
+  Vector<size_t> offsets((src.Size() + grain - 1) / grain + 1, 0);
+  ParallelChunks(src.Size(), sizeof(T), options, [&](size_t chunk, size_t begin, size_t end) {
+    size_t count = 0;
+    for (size_t i = begin; i < end; ++i) {
+      keep[i] = pred(src[i]) ? 1 : 0;
+      count += keep[i];
+    }
+    offsets[chunk + 1] = count;
+  });
+  for (size_t chunk = 1; chunk < offsets.Size(); ++chunk) {
+    offsets[chunk] += offsets[chunk - 1];
+  }
+  dst.Resize(offsets.Empty() ? 0 : offsets.Back());
+  ParallelChunks(src.Size(), sizeof(T), options, [&](size_t chunk, size_t begin, size_t end) {
+    size_t out = offsets[chunk];
+    for (size_t i = begin; i < end; ++i) {
+      if (keep[i] != 0) {
+        dst[out++] = src[i];
+      }
+    }
+  });
+}
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_PARALLEL_H_
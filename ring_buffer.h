@@ -0,0 +1,375 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_RING_BUFFER_H_
+#define OOP_ASSIGNMENTS_VECTOR_RING_BUFFER_H_
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "vector.h"
+
+// Throws std::length_error if the result does not fit in size_t.
+[[nodiscard]] inline size_t RoundUpToPowerOfTwo(size_t value) {
+  constexpr size_t kLargest = ~(~size_t{0} >> 1);
+  if (value > kLargest) {
+    throw std::length_error("RoundUpToPowerOfTwo: value too large");
+  }
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+// Fixed-capacity double-ended queue over a single RawStorage buffer. With kPowerOfTwo
+// the capacity is rounded up to a power of two and slots are found by masking.
+template <typename T, bool kPowerOfTwo = false>
+class RingBuffer {
+ public:
+  using ValueType = T;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+
+  RingBuffer() noexcept = default;
+
+  explicit RingBuffer(size_t capacity) {
+    if (capacity == 0) {
+      return;
+    }
+    capacity_ = kPowerOfTwo ? RoundUpToPowerOfTwo(capacity) : capacity;
+    buffer_ = RawStorage<T>::Allocate(capacity_);
+  }
+
+  // Delegating keeps the destructor responsible for cleanup if a copy throws.
+  RingBuffer(const RingBuffer& other) : RingBuffer(other.capacity_) {
+    for (size_t i = 0; i < other.size_; ++i) {
+      new (buffer_ + i) T(other[i]);
+      ++size_;
+    }
+  }
+
+  RingBuffer(RingBuffer&& other) noexcept
+      : buffer_(std::exchange(other.buffer_, nullptr))
+      , capacity_(std::exchange(other.capacity_, 0))
+      , head_(std::exchange(other.head_, 0))
+      , size_(std::exchange(other.size_, 0)) {
+  }
+
+  RingBuffer& operator=(const RingBuffer& other) {
+    if (this != &other) {
+      RingBuffer(other).Swap(*this);
+    }
+    return *this;
+  }
+
+  RingBuffer& operator=(RingBuffer&& other) noexcept {
+    if (this != &other) {
+      RingBuffer(std::move(other)).Swap(*this);
+    }
+    return *this;
+  }
+
+  ~RingBuffer() noexcept(std::is_nothrow_destructible_v<ValueType>) {
+    Clear();
+    RawStorage<T>::Deallocate(buffer_);
+    buffer_ = nullptr;
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] SizeType Capacity() const noexcept {
+    return capacity_;
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] bool Full() const noexcept {
+    return size_ == capacity_;
+  }
+
+  [[nodiscard]] ConstReference operator[](size_t idx) const noexcept {
+    return buffer_[Wrap(head_ + idx)];
+  }
+
+  [[nodiscard]] Reference operator[](size_t idx) noexcept {
+    return buffer_[Wrap(head_ + idx)];
+  }
+
+  [[nodiscard]] ConstReference At(size_t idx) const {
+    if (idx >= size_) {
+      throw std::out_of_range("");
+    }
+    return (*this)[idx];
+  }
+
+  [[nodiscard]] Reference At(size_t idx) {
+    if (idx >= size_) {
+      throw std::out_of_range("");
+    }
+    return (*this)[idx];
+  }
+
+  [[nodiscard]] ConstReference Front() const noexcept {
+    return buffer_[head_];
+  }
+
+  [[nodiscard]] Reference Front() noexcept {
+    return buffer_[head_];
+  }
+
+  [[nodiscard]] ConstReference Back() const noexcept {
+    return (*this)[size_ - 1];
+  }
+
+  [[nodiscard]] Reference Back() noexcept {
+    return (*this)[size_ - 1];
+  }
+
+  void Swap(RingBuffer& other) noexcept {
+    std::swap(buffer_, other.buffer_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+  }
+
+  // Push operations return false and leave the buffer unchanged when it is full.
+  template <typename... Args>
+  bool EmplaceBack(Args&&... args) {
+    if (Full()) {
+      return false;
+    }
+    new (buffer_ + Wrap(head_ + size_)) T(std::forward<Args>(args)...);
+    ++size_;
+    return true;
+  }
+
+  bool PushBack(const T& value) {
+    return EmplaceBack(value);
+  }
+
+  bool PushBack(T&& value) {
+    return EmplaceBack(std::move(value));
+  }
+
+  template <typename... Args>
+  bool EmplaceFront(Args&&... args) {
+    if (Full()) {
+      return false;
+    }
+    size_t slot = Wrap(head_ + capacity_ - 1);
+    new (buffer_ + slot) T(std::forward<Args>(args)...);
+    head_ = slot;
+    ++size_;
+    return true;
+  }
+
+  bool PushFront(const T& value) {
+    return EmplaceFront(value);
+  }
+
+  bool PushFront(T&& value) {
+    return EmplaceFront(std::move(value));
+  }
+
+  void PopFront() noexcept(std::is_nothrow_destructible_v<ValueType>) {
+    if (size_ == 0) {
+      return;
+    }
+    (buffer_ + head_)->~T();
+    head_ = Wrap(head_ + 1);
+    --size_;
+  }
+
+  void PopBack() noexcept(std::is_nothrow_destructible_v<ValueType>) {
+    if (size_ == 0) {
+      return;
+    }
+    --size_;
+    (buffer_ + Wrap(head_ + size_))->~T();
+  }
+
+  // Copies up to `count` elements from `data` to the back in at most two
+  // contiguous runs and returns the number copied.
+  size_t PushN(const T* data, size_t count) {
+    count = std::min(count, capacity_ - size_);
+    size_t tail = Wrap(head_ + size_);
+    size_t first = std::min(count, capacity_ - tail);
+    RawStorage<T>::UninitializedCopy(data, first, buffer_ + tail);
+    size_ += first;
+    RawStorage<T>::UninitializedCopy(data + first, count - first, buffer_);
+    size_ += count - first;
+    return count;
+  }
+
+  // Moves up to `count` elements from the front into `out` in at most two
+  // contiguous runs and returns the number moved.
+  size_t PopN(T* out, size_t count) {
+    count = std::min(count, size_);
+    size_t first = std::min(count, capacity_ - head_);
+    std::move(buffer_ + head_, buffer_ + head_ + first, out);
+    std::move(buffer_, buffer_ + (count - first), out + first);
+    std::destroy_n(buffer_ + head_, first);
+    std::destroy_n(buffer_, count - first);
+    head_ = size_ == count ? 0 : Wrap(head_ + count);
+    size_ -= count;
+    return count;
+  }
+
+  void Clear() noexcept(std::is_nothrow_destructible_v<ValueType>) {
+    while (size_ != 0) {
+      PopBack();
+    }
+    head_ = 0;
+  }
+
+ private:
+  // `idx` is always below 2 * capacity_, so a single conditional subtraction wraps it.
+  [[nodiscard]] size_t Wrap(size_t idx) const noexcept {
+    if constexpr (kPowerOfTwo) {
+      return idx & (capacity_ - 1);
+    } else {
+      return idx >= capacity_ ? idx - capacity_ : idx;
+    }
+  }
+
+ private:
+  T* buffer_{nullptr};
+  size_t capacity_{0};
+  size_t head_{0};
+  size_t size_{0};
+};
+
+// Lock-free single-producer/single-consumer queue. Positions are free-running
+// counters masked into a power-of-two buffer; the producer and consumer indices
+// sit on separate cache lines and each side caches the other's last seen index.
+template <typename T>
+class SpscRingBuffer {
+ public:
+  using ValueType = T;
+  using SizeType = size_t;
+
+  static constexpr size_t kCacheLineSize = 64;
+
+  explicit SpscRingBuffer(size_t capacity)
+      : capacity_(RoundUpToPowerOfTwo(std::max<size_t>(capacity, 1)))
+      , mask_(capacity_ - 1)
+      , buffer_(RawStorage<T>::Allocate(capacity_)) {
+  }
+
+  SpscRingBuffer(const SpscRingBuffer&) = delete;
+  SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+  ~SpscRingBuffer() noexcept(std::is_nothrow_destructible_v<ValueType>) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    for (size_t head = head_.load(std::memory_order_relaxed); head != tail; ++head) {
+      (buffer_ + (head & mask_))->~T();
+    }
+    RawStorage<T>::Deallocate(buffer_);
+  }
+
+  [[nodiscard]] SizeType Capacity() const noexcept {
+    return capacity_;
+  }
+
+  // Exact only when called from the producer or consumer while the other side is idle.
+  // Loading head before tail keeps the difference from going negative: tail
+  // never trails a head read earlier. Between the two loads the consumer may pop
+  // and the producer refill, so the difference is clamped to Capacity().
+  [[nodiscard]] SizeType SizeApprox() const noexcept {
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    return std::min(tail - head, capacity_);
+  }
+
+  // Producer side.
+  template <typename... Args>
+  bool TryEmplace(Args&&... args) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ == capacity_) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ == capacity_) {
+        return false;
+      }
+    }
+    new (buffer_ + (tail & mask_)) T(std::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPush(const T& value) {
+    return TryEmplace(value);
+  }
+
+  bool TryPush(T&& value) {
+    return TryEmplace(std::move(value));
+  }
+
+  // Producer side. Publishes up to `count` elements with a single release store.
+  size_t PushN(const T* data, size_t count) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (capacity_ - (tail - cached_head_) < count) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+    }
+    count = std::min(count, capacity_ - (tail - cached_head_));
+    size_t slot = tail & mask_;
+    size_t first = std::min(count, capacity_ - slot);
+    RawStorage<T>::UninitializedCopy(data, first, buffer_ + slot);
+    try {
+      RawStorage<T>::UninitializedCopy(data + first, count - first, buffer_);
+    } catch (...) {
+      std::destroy_n(buffer_ + slot, first);
+      throw;
+    }
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  // Consumer side.
+  bool TryPop(T& out) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) {
+        return false;
+      }
+    }
+    T* slot = buffer_ + (head & mask_);
+    out = std::move(*slot);
+    slot->~T();
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Releases up to `count` slots with a single release store.
+  size_t PopN(T* out, size_t count) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (cached_tail_ - head < count) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+    }
+    count = std::min(count, cached_tail_ - head);
+    size_t slot = head & mask_;
+    size_t first = std::min(count, capacity_ - slot);
+    std::move(buffer_ + slot, buffer_ + slot + first, out);
+    std::move(buffer_, buffer_ + (count - first), out + first);
+    std::destroy_n(buffer_ + slot, first);
+    std::destroy_n(buffer_, count - first);
+    head_.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+ private:
+  const size_t capacity_;
+  const size_t mask_;
+  T* const buffer_;
+  alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+  size_t cached_head_{0};
+  alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+  size_t cached_tail_{0};
+};
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_RING_BUFFER_H_
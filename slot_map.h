@@ -0,0 +1,187 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_SLOT_MAP_H_
+#define OOP_ASSIGNMENTS_VECTOR_SLOT_MAP_H_
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include "vector.h"
+
+// Stable reference to a SlotMap element. A handle stops resolving once its
+// element is erased, even after the slot is reused. Default handles never resolve.
+struct SlotHandle {
+  uint32_t index{0};
+  uint32_t generation{0};
+};
+
+[[nodiscard]] inline bool operator==(const SlotHandle& a, const SlotHandle& b) noexcept {
+  return a.index == b.index && a.generation == b.generation;
+}
+
+[[nodiscard]] inline bool operator!=(const SlotHandle& a, const SlotHandle& b) noexcept {
+  return !(a == b);
+}
+
+// Live elements are stored densely in a Vector and iterate without holes; an
+// indirection table of slots maps handles to dense positions. Erase moves the
+// last element into the hole, so iteration order is not insertion order.
+template <typename T>
+class SlotMap {
+ public:
+  using ValueType = T;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+  using Handle = SlotHandle;
+  using Iterator = typename Vector<T>::Iterator;
+  using ConstIterator = typename Vector<T>::ConstIterator;
+
+ private:
+  static constexpr uint32_t kNoSlot = std::numeric_limits<uint32_t>::max();
+
+  // For a live slot `link` is the dense position of its element, for a free
+  // slot it is the next free slot.
+  struct Slot {
+    uint32_t link{kNoSlot};
+    uint32_t generation{1};
+  };
+
+ public:
+  SlotMap() noexcept = default;
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return values_.Size();
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return values_.Empty();
+  }
+
+  void Reserve(size_t capacity) {
+    values_.Reserve(capacity);
+    dense_to_slot_.Reserve(capacity);
+    slots_.Reserve(capacity);
+  }
+
+  template <typename... Args>
+  Handle Emplace(Args&&... args) {
+    if (free_head_ == kNoSlot) {
+      if (slots_.Size() >= kNoSlot) {
+        throw std::length_error("SlotMap: too many slots");
+      }
+      slots_.PushBack(Slot());
+      free_head_ = static_cast<uint32_t>(slots_.Size() - 1);
+    }
+    uint32_t slot = free_head_;
+    values_.EmplaceBack(std::forward<Args>(args)...);
+    try {
+      dense_to_slot_.PushBack(slot);
+    } catch (...) {
+      values_.PopBack();
+      throw;
+    }
+    free_head_ = slots_[slot].link;
+    slots_[slot].link = static_cast<uint32_t>(values_.Size() - 1);
+    return Handle{slot, slots_[slot].generation};
+  }
+
+  Handle Insert(const T& value) {
+    return Emplace(value);
+  }
+
+  Handle Insert(T&& value) {
+    return Emplace(std::move(value));
+  }
+
+  bool Erase(Handle handle) {
+    if (!Contains(handle)) {
+      return false;
+    }
+    Slot& slot = slots_[handle.index];
+    size_t dense = slot.link;
+    size_t last = values_.Size() - 1;
+    if (dense != last) {
+      values_[dense] = std::move(values_[last]);
+      dense_to_slot_[dense] = dense_to_slot_[last];
+      slots_[dense_to_slot_[dense]].link = static_cast<uint32_t>(dense);
+    }
+    values_.PopBack();
+    dense_to_slot_.PopBack();
+    ++slot.generation;
+    if (slot.generation == 0) {
+      slot.generation = 1;
+    }
+    slot.link = free_head_;
+    free_head_ = handle.index;
+    return true;
+  }
+
+  // A free slot already carries the generation its next element will get, so
+  // liveness is checked through the dense back-link as well.
+  [[nodiscard]] bool Contains(Handle handle) const noexcept {
+    if (handle.index >= slots_.Size() || handle.generation == 0) {
+      return false;
+    }
+    const Slot& slot = slots_[handle.index];
+    return slot.generation == handle.generation && slot.link < values_.Size() &&
+           dense_to_slot_[slot.link] == handle.index;
+  }
+
+  [[nodiscard]] const T* Get(Handle handle) const noexcept {
+    return Contains(handle) ? values_.Data() + slots_[handle.index].link : nullptr;
+  }
+
+  [[nodiscard]] T* Get(Handle handle) noexcept {
+    return Contains(handle) ? values_.Data() + slots_[handle.index].link : nullptr;
+  }
+
+  [[nodiscard]] ConstReference At(Handle handle) const {
+    if (!Contains(handle)) {
+      throw std::out_of_range("");
+    }
+    return values_[slots_[handle.index].link];
+  }
+
+  [[nodiscard]] Reference At(Handle handle) {
+    if (!Contains(handle)) {
+      throw std::out_of_range("");
+    }
+    return values_[slots_[handle.index].link];
+  }
+
+  // Handle of the element at dense position `idx`, e.g. while iterating.
+  [[nodiscard]] Handle HandleAt(size_t idx) const noexcept {
+    uint32_t slot = dense_to_slot_[idx];
+    return Handle{slot, slots_[slot].generation};
+  }
+
+  // Erases every element; all outstanding handles stop resolving.
+  void Clear() {
+    while (!values_.Empty()) {
+      Erase(HandleAt(values_.Size() - 1));
+    }
+  }
+
+  [[nodiscard]] ConstIterator begin() const noexcept {  // NOLINT
+    return values_.begin();
+  }
+
+  [[nodiscard]] Iterator begin() noexcept {  // NOLINT
+    return values_.begin();
+  }
+
+  [[nodiscard]] ConstIterator end() const noexcept {  // NOLINT
+    return values_.end();
+  }
+
+  [[nodiscard]] Iterator end() noexcept {  // NOLINT
+    return values_.end();
+  }
+
+ private:
+  Vector<T> values_;
+  Vector<uint32_t> dense_to_slot_;
+  Vector<Slot> slots_;
+  uint32_t free_head_{kNoSlot};
+};
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_SLOT_MAP_H_
@@ -6,7 +6,75 @@
 #include <stdexcept>
 #include <exception>
 #include <algorithm>
+#include <utility>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#if __cplusplus >= 202002L
+#include <ranges>
+#endif
 // sd::pair<score, trackid>, decltype(cmp)> queue(cmp);
+
+// Automatic shrinking for Vector. Once Size() falls below `low_water` of the
+// capacity, the capacity drops to `headroom` * Size() (at least `min_capacity`).
+// low_water * headroom must stay below 1 so a shrink is never undone by the
+// next doubling. A Vector only points at its policy, so one policy can be shared
+// by many vectors and must outlive them; a Vector without one never shrinks.
+struct ShrinkPolicy {
+  float low_water{0.0F};
+  float headroom{2.0F};
+  size_t min_capacity{0};
+};
+
+// Uninitialized element storage used by Vector and by the containers built
+// next to it (see ring_buffer.h): allocation, release and bulk construction.
+template <typename T>
+struct RawStorage {
+  [[nodiscard]] static T* Allocate(size_t count) {
+    return static_cast<T*>(operator new(sizeof(T) * count));
+  }
+
+  static void Deallocate(T* buffer) noexcept {
+    operator delete(buffer);
+  }
+
+  // The construction helpers, like the std::uninitialized_* algorithms they fall
+  // back to, destroy what they built if a constructor throws. Trivial types are
+  // handled with bulk memset/memcpy or a plain fill loop that compilers turn into
+  // vector broadcast stores.
+  static void UninitializedDefault(T* dst, size_t count) {
+    if constexpr (!std::is_trivially_default_constructible_v<T>) {
+      std::uninitialized_default_construct_n(dst, count);
+    }
+  }
+
+  static void UninitializedFill(T* dst, size_t count, const T& value) {
+    if constexpr (std::is_trivial_v<T>) {
+      unsigned char bytes[sizeof(T)];
+      std::memcpy(bytes, &value, sizeof(T));
+      if (std::all_of(bytes, bytes + sizeof(T), [&](unsigned char byte) { return byte == bytes[0]; })) {
+        std::memset(dst, bytes[0], count * sizeof(T));
+      } else {
+        std::fill_n(dst, count, value);
+      }
+    } else {
+      std::uninitialized_fill_n(dst, count, value);
+    }
+  }
+
+  template <typename Iter>
+  static void UninitializedCopy(Iter src, size_t count, T* dst) {
+    using Source = std::remove_cv_t<std::remove_pointer_t<Iter>>;
+    if constexpr (std::is_pointer_v<Iter> && std::is_same_v<Source, T> && std::is_trivially_copyable_v<T>) {
+      if (count != 0) {
+        std::memcpy(dst, src, count * sizeof(T));
+      }
+    } else {
+      std::uninitialized_copy_n(src, count, dst);
+    }
+  }
+};
+
 template <typename T>
 class Vector {
  public:
@@ -22,9 +90,34 @@ class Vector {
   using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
 
  private:
+  using Storage = RawStorage<T>;
+
+  template <class Iter>
+  using IteratorCategory = typename std::iterator_traits<Iter>::iterator_category;
+
   template <class Iter>
-  using EnableIfForwardIter = std::enable_if_t<
-      std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>;
+  using EnableIfInputIter = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag, IteratorCategory<Iter>>, int>;
+
+  template <class Iter>
+  using EnableIfForwardIter =
+      std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, IteratorCategory<Iter>>, int>;
+
+  template <class Iter>
+  using EnableIfSinglePassIter =
+      std::enable_if_t<std::is_base_of_v<std::input_iterator_tag, IteratorCategory<Iter>> &&
+                           !std::is_base_of_v<std::forward_iterator_tag, IteratorCategory<Iter>>,
+                       int>;
+
+  // Lazily evaluated expressions (vector_expr.h) write straight into the buffer.
+  template <class Expr>
+  using EnableIfEvaluatesInto =
+      std::enable_if_t<std::is_void_v<decltype(std::declval<const Expr&>().EvaluateInto(std::declval<Vector&>()))>,
+                       int>;
+
+  // Smallest growth step, in bytes, when appending from a source of unknown length.
+  static constexpr size_t kAppendBatchBytes = 4096;
+
+  static constexpr ShrinkPolicy kDefaultShrinkPolicy{};
 
  public:
   Vector() noexcept = default;
@@ -34,24 +127,14 @@ class Vector {
     size_ = 0;
     capacity_ = 0;
     buffer_ = nullptr;
-    size_t i = 0;
     try {
       if (end != begin) {
         size_ = capacity_ = end - begin;
-        buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
-        while (begin != end) {
-          new (buffer_ + i) T(*begin);
-          ++begin;
-          ++i;
-        }
+        buffer_ = Storage::Allocate(capacity_);
+        Storage::UninitializedCopy(begin, size_, buffer_);
       }
     } catch (...) {
-      if (buffer_ != nullptr) {
-        for (size_t j = i; j >= 1; --j) {
-          (buffer_ + j - 1)->~T();
-        }
-        operator delete(buffer_);
-      }
+      Storage::Deallocate(buffer_);
       size_ = capacity_ = 0;
       buffer_ = nullptr;
       throw;
@@ -60,43 +143,48 @@ class Vector {
 
   /// Vector(std::initializer_list<T>&& init_lst);
 
-  template <typename InputIterator, typename = EnableIfForwardIter<InputIterator>>
-  Vector(InputIterator begin, InputIterator end) {
+  template <typename ForwardIterator, EnableIfForwardIter<ForwardIterator> = 0>
+  Vector(ForwardIterator begin, ForwardIterator end) {
     size_ = 0;
     capacity_ = 0;
     buffer_ = nullptr;
-    size_t i = 0;
     try {
       if (end != begin) {
-        size_ = capacity_ = end - begin;
-        buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
-        while (begin != end) {
-          new (buffer_ + i) T(*begin);
-          ++begin;
-          ++i;
-        }
+        size_ = capacity_ = static_cast<size_t>(std::distance(begin, end));
+        buffer_ = Storage::Allocate(capacity_);
+        Storage::UninitializedCopy(begin, size_, buffer_);
       }
     } catch (...) {
-      if (buffer_ != nullptr) {
-        for (size_t j = i; j >= 1; --j) {
-          (buffer_ + j - 1)->~T();
-        }
-        operator delete(buffer_);
-      }
+      Storage::Deallocate(buffer_);
       size_ = capacity_ = 0;
       buffer_ = nullptr;
       throw;
     }
   }
 
-  Vector(const Vector& other) {
-    size_t i = 0;
+  // Single-pass iterators cannot be measured up front; `size_hint` (if known)
+  // is reserved before reading, otherwise the buffer grows in large batches.
+  template <typename InputIterator, EnableIfSinglePassIter<InputIterator> = 0>
+  Vector(InputIterator begin, InputIterator end, size_t size_hint = 0) {
+    try {
+      Append(begin, end, size_hint);
+    } catch (...) {
+      Clear();
+      throw;
+    }
+  }
+
+#if __cplusplus >= 202002L
+  template <std::ranges::input_range Range>
+  [[nodiscard]] static Vector FromRange(Range&& range) {
+    Vector result;
+    result.AppendRange(std::forward<Range>(range));
+    return result;
+  }
+#endif
+
+  Vector(const Vector& other) : shrink_policy_(other.shrink_policy_) {
     try {
-      for (; i < size_; i++) {
-        (buffer_ + i)->~T();
-      }
-      operator delete(buffer_);
-      buffer_ = nullptr;
       if (other.buffer_ == nullptr) {
         size_ = 0;
         capacity_ = 0;
@@ -104,18 +192,10 @@ class Vector {
       }
       capacity_ = other.capacity_;
       size_ = other.size_;
-      buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
-      i = 0;
-      for (; i < size_; ++i) {
-        new (buffer_ + i) T(other.buffer_[i]);
-      }
+      buffer_ = Storage::Allocate(capacity_);
+      Storage::UninitializedCopy(other.buffer_, size_, buffer_);
     } catch (...) {
-      if (buffer_ != nullptr) {
-        for (size_t j = i; j >= 1; --j) {
-          (buffer_ + j - 1)->~T();
-        }
-        operator delete(buffer_);
-      }
+      Storage::Deallocate(buffer_);
       size_ = capacity_ = 0;
       buffer_ = nullptr;
       throw;
@@ -125,11 +205,11 @@ class Vector {
   Vector(Vector&& other) noexcept
       : buffer_(std::exchange(other.buffer_, nullptr))
       , size_(std::exchange(other.size_, 0))
-      , capacity_(std::exchange(other.capacity_, 0)) {
+      , capacity_(std::exchange(other.capacity_, 0))
+      , shrink_policy_(other.shrink_policy_) {
   }
 
   explicit Vector(size_t size) {
-    size_t i = 0;
     size_ = 0;
     capacity_ = 0;
     buffer_ = nullptr;
@@ -137,18 +217,11 @@ class Vector {
       if (size != 0) {
         size_ = size;
         capacity_ = size_;
-        buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
-        for (; i < capacity_; ++i) {
-          new (buffer_ + i) T;
-        }
+        buffer_ = Storage::Allocate(capacity_);
+        Storage::UninitializedDefault(buffer_, capacity_);
       }
     } catch (...) {
-      if (buffer_ != nullptr) {
-        for (size_t j = i; j >= 1; --j) {
-          (buffer_ + j - 1)->~T();
-        }
-        operator delete(buffer_);
-      }
+      Storage::Deallocate(buffer_);
       size_ = capacity_ = 0;
       buffer_ = nullptr;
       throw;
@@ -156,7 +229,6 @@ class Vector {
   }
 
   Vector(size_t size, const T& value) {
-    size_t i = 0;
     size_ = 0;
     capacity_ = 0;
     buffer_ = nullptr;
@@ -164,24 +236,28 @@ class Vector {
       if (size != 0) {
         size_ = size;
         capacity_ = size_;
-        buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
-        for (; i < capacity_; ++i) {
-          new (buffer_ + i) T(value);
-        }
+        buffer_ = Storage::Allocate(capacity_);
+        Storage::UninitializedFill(buffer_, capacity_, value);
       }
     } catch (...) {
-      if (buffer_ != nullptr) {
-        for (size_t j = i; j >= 1; --j) {
-          (buffer_ + j - 1)->~T();
-        }
-        operator delete(buffer_);
-      }
+      Storage::Deallocate(buffer_);
       size_ = capacity_ = 0;
       buffer_ = nullptr;
       throw;
     }
   }
 
+  template <typename Expr, EnableIfEvaluatesInto<Expr> = 0>
+  Vector(const Expr& expr) {  // NOLINT
+    expr.EvaluateInto(*this);
+  }
+
+  template <typename Expr, EnableIfEvaluatesInto<Expr> = 0>
+  Vector& operator=(const Expr& expr) {
+    expr.EvaluateInto(*this);
+    return *this;
+  }
+
   Vector& operator=(const Vector& other) {
     if (this != &other) {
       auto backup_buff = std::exchange(buffer_, nullptr);
@@ -192,7 +268,7 @@ class Vector {
         for (size_t i = 0; i < backup_size; i++) {
           (backup_buff + i)->~T();
         }
-        operator delete(backup_buff);
+        Storage::Deallocate(backup_buff);
       } catch (...) {
         buffer_ = backup_buff;
         size_ = backup_size;
@@ -214,7 +290,7 @@ class Vector {
     for (size_t i = 0; i < size_; ++i) {
       (buffer_ + i)->~T();
     }
-    operator delete(buffer_);
+    Storage::Deallocate(buffer_);
     buffer_ = nullptr;
   }
 
@@ -276,176 +352,79 @@ class Vector {
     return buffer_;
   }
 
+  // Exchanges contents only; each Vector keeps its own shrink policy, as it
+  // does across copy and move assignment. Neither swap nor assignment shrinks
+  // by itself: a move hands the buffer over untouched and the policy applies
+  // from the next PopBack or Resize. Copy and move construction adopt the
+  // source's policy.
   void Swap(Vector& other) noexcept {
     std::swap(buffer_, other.buffer_);
     std::swap(size_, other.size_);
     std::swap(capacity_, other.capacity_);
   }
 
+  [[nodiscard]] const ShrinkPolicy* GetShrinkPolicy() const noexcept {
+    return shrink_policy_;
+  }
+
+  // Pass nullptr to stop shrinking.
+  void SetShrinkPolicy(const ShrinkPolicy* policy) noexcept {
+    shrink_policy_ = policy;
+    MaybeAutoShrink();
+  }
+
+  // Reallocates down to the policy's headroom over Size() if that releases
+  // memory, regardless of the low-water mark; without a policy the default
+  // ShrinkPolicy headroom applies. Returns the number of bytes freed.
+  size_t TrimSlack() {
+    const ShrinkPolicy& policy = shrink_policy_ != nullptr ? *shrink_policy_ : kDefaultShrinkPolicy;
+    size_t target = static_cast<size_t>(static_cast<double>(size_) * policy.headroom);
+    target = std::max({target, size_, policy.min_capacity});
+    if (target >= capacity_) {
+      return 0;
+    }
+    size_t released = (capacity_ - target) * sizeof(T);
+    Reallocate(target);
+    return released;
+  }
+
   void Resize(size_t size, const T& value) {
-    auto backup_buff = buffer_;
-    auto backup_size = size_;
-    auto backup_capacity = capacity_;
-    if (size_ == size) {
+    if (size == size_) {
       return;
     }
-    try {
-      if (size > capacity_) {
-        buffer_ = nullptr;
-        capacity_ = size;
-        if (backup_buff == nullptr) {
-          size_t i = 0;
-          try {
-            buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
-            for (; i < size; ++i) {
-              new (buffer_ + i) T(value);
-            }
-          } catch (...) {
-            if (buffer_ != nullptr) {
-              for (size_t j = i; j >= 1; --j) {
-                (buffer_ + j - 1)->~T();
-              }
-              operator delete(buffer_);
-            }
-            buffer_ = nullptr;
-            throw;
-          }
-        } else {
-          size_t i = 0;
-          try {
-            buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
-            for (; i < size; ++i) {  // 0
-              new (buffer_ + i) T;
-            }
-          } catch (...) {
-            if (buffer_ != nullptr) {
-              for (size_t j = i; j >= 1; --j) {
-                (buffer_ + j - 1)->~T();
-              }
-              operator delete(buffer_);
-            }
-            buffer_ = nullptr;
-            throw;
-          }
-          for (i = backup_size; i < size; ++i) {
-            *(buffer_ + i) = T(value);
-          }
-          for (i = 0; i < backup_size; ++i) {
-            *(buffer_ + i) = T(std::move(backup_buff[i]));
-          }
-          for (i = 0; i < backup_size; ++i) {
-            (backup_buff + i)->~T();
-          }
-          operator delete(backup_buff);
-        }
-      } else {
-        if (size > size_) {
-          try {
-            for (size_t i = size_; i < size; ++i) {
-              *(buffer_ + i) = T(value);
-            }
-          } catch (...) {
-            buffer_ = nullptr;
-          }
-        } else {
-          for (size_t i = size; i < size_; ++i) {
-            (buffer_ + i)->~T();
-            // new (buffer_+i) T;
-          }
-          // capacity_ = size;
-        }
-      }
+    if (size < size_) {
+      std::destroy(buffer_ + size, buffer_ + size_);
       size_ = size;
-    } catch (...) {
-      if (buffer_ != nullptr) {
-        for (size_t i = 0; i < capacity_; ++i) {
-          (buffer_ + i)->~T();
-        }
-        operator delete(buffer_);
+      MaybeAutoShrink();
+      return;
+    }
+    if (size > capacity_) {
+      if (!std::less<const T*>()(&value, buffer_) && std::less<const T*>()(&value, buffer_ + size_)) {
+        T copy(value);
+        Resize(size, copy);
+        return;
       }
-      buffer_ = backup_buff;
-      size_ = backup_size;
-      capacity_ = backup_capacity;
-      throw;
+      Reallocate(size);
     }
+    Storage::UninitializedFill(buffer_ + size_, size - size_, value);
+    size_ = size;
   }
 
   void Resize(size_t size) {
-    auto backup_buff = buffer_;
-    auto backup_size = size_;
-    auto backup_capacity = capacity_;
-    try {
-      if (size > capacity_) {
-        buffer_ = nullptr;
-        capacity_ = size;
-        if (backup_buff == nullptr) {
-          size_t i = 0;
-          try {
-            buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
-            for (; i < size; ++i) {
-              new (buffer_ + i) T;
-            }
-          } catch (...) {
-            if (buffer_ != nullptr) {
-              for (size_t j = i; j >= 1; --j) {
-                (buffer_ + j - 1)->~T();
-              }
-              operator delete(buffer_);
-            }
-            buffer_ = nullptr;
-            throw;
-          }
-        } else {
-          size_t i = 0;
-          try {
-            buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
-            for (; i < size; ++i) {  // 0
-              new (buffer_ + i) T;
-            }
-          } catch (...) {
-            if (buffer_ != nullptr) {
-              for (size_t j = i; j >= 1; --j) {
-                (buffer_ + j - 1)->~T();
-              }
-              operator delete(buffer_);
-            }
-            buffer_ = nullptr;
-            throw;
-          }
-          for (i = 0; i < backup_size; ++i) {
-            *(buffer_ + i) = T(std::move(backup_buff[i]));
-          }
-          for (i = 0; i < backup_size; ++i) {
-            (backup_buff + i)->~T();
-          }
-          operator delete(backup_buff);
-        }
-      } else {
-        if (size > size_) {
-          for (size_t i = size_; i < size; ++i) {
-            new (buffer_ + i) T;
-          }
-          size_ = size;
-          return;
-        }
-        for (size_t i = size; i < size_; ++i) {
-          (buffer_ + i)->~T();
-          // new (buffer_ + i) T;
-        }
-      }
+    if (size == size_) {
+      return;
+    }
+    if (size < size_) {
+      std::destroy(buffer_ + size, buffer_ + size_);
       size_ = size;
-    } catch (...) {
-      if (buffer_ != nullptr) {
-        for (size_t i = 0; i < capacity_; ++i) {
-          (buffer_ + i)->~T();
-        }
-        operator delete(buffer_);
-      }
-      buffer_ = backup_buff;
-      size_ = backup_size;
-      capacity_ = backup_capacity;
-      throw;
+      MaybeAutoShrink();
+      return;
     }
+    if (size > capacity_) {
+      Reallocate(size);
+    }
+    Storage::UninitializedDefault(buffer_ + size_, size - size_);
+    size_ = size;
   }
 
   void Reserve(size_t capacity) {
@@ -461,7 +440,7 @@ class Vector {
       if (backup_buff == nullptr) {
         size_t i = 0;
         try {
-          buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
+          buffer_ = Storage::Allocate(capacity_);
           // for (; i < capacity_; ++i) {
           // new (buffer_ + i) T;
           //}
@@ -470,7 +449,7 @@ class Vector {
             for (size_t j = i; j >= 1; --j) {
               (buffer_ + j - 1)->~T();
             }
-            operator delete(buffer_);
+            Storage::Deallocate(buffer_);
           }
           buffer_ = nullptr;
           throw;
@@ -478,7 +457,7 @@ class Vector {
       } else {
         size_t i = 0;
         try {
-          buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
+          buffer_ = Storage::Allocate(capacity_);
           for (; i < size_; ++i) {  // 0
             new (buffer_ + i) T;
           }
@@ -487,7 +466,7 @@ class Vector {
             for (size_t j = i; j >= 1; --j) {
               (buffer_ + j - 1)->~T();
             }
-            operator delete(buffer_);
+            Storage::Deallocate(buffer_);
           }
           buffer_ = nullptr;
           throw;
@@ -498,14 +477,14 @@ class Vector {
         for (i = 0; i < backup_size; ++i) {
           (backup_buff + i)->~T();
         }
-        operator delete(backup_buff);
+        Storage::Deallocate(backup_buff);
       }
     } catch (...) {
       if (buffer_ != nullptr) {
         for (size_t i = 0; i < capacity_; ++i) {
           (buffer_ + i)->~T();
         }
-        operator delete(buffer_);
+        Storage::Deallocate(buffer_);
       }
       buffer_ = backup_buff;
       size_ = backup_size;
@@ -524,7 +503,7 @@ class Vector {
         //(buffer_ + i)->~T();
         //}
         capacity_ = size_;
-        operator delete(buffer_);
+        Storage::Deallocate(buffer_);
         buffer_ = nullptr;
         return;
       } catch (...) {
@@ -540,7 +519,7 @@ class Vector {
       capacity_ = size_;
       size_t i = 0;
       try {
-        buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
+        buffer_ = Storage::Allocate(capacity_);
         for (; i < backup_size; ++i) {  // 0
           new (buffer_ + i) T;
         }
@@ -549,7 +528,7 @@ class Vector {
           for (size_t j = i; j >= 1; --j) {
             (buffer_ + j - 1)->~T();
           }
-          operator delete(buffer_);
+          Storage::Deallocate(buffer_);
         }
         buffer_ = nullptr;
         throw;
@@ -560,13 +539,13 @@ class Vector {
       for (i = 0; i < backup_size; ++i) {
         (backup_buff + i)->~T();
       }
-      operator delete(backup_buff);
+      Storage::Deallocate(backup_buff);
     } catch (...) {
       if (buffer_ != nullptr) {
         for (size_t i = 0; i < capacity_; ++i) {  // 0
           (buffer_ + i)->~T();
         }
-        operator delete(buffer_);
+        Storage::Deallocate(buffer_);
       }
       buffer_ = backup_buff;
       size_ = backup_size;
@@ -580,7 +559,7 @@ class Vector {
       (buffer_ + i)->~T();
     }
     size_ = 0;
-    operator delete(buffer_);
+    Storage::Deallocate(buffer_);
     buffer_ = nullptr;
     capacity_ = 0;
   }
@@ -604,7 +583,7 @@ class Vector {
       buffer_ = nullptr;
       size_t i = 0;
       try {
-        buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
+        buffer_ = Storage::Allocate(capacity_);
         for (; i < size_ + 1; ++i) {  // 0
           new (buffer_ + i) T;
         }
@@ -613,7 +592,7 @@ class Vector {
           for (size_t j = i; j >= 1; --j) {
             (buffer_ + j - 1)->~T();
           }
-          operator delete(buffer_);
+          Storage::Deallocate(buffer_);
         }
         buffer_ = nullptr;
         throw;
@@ -626,13 +605,13 @@ class Vector {
       for (i = 0; i < backup_size; ++i) {
         (backup_buff + i)->~T();
       }
-      operator delete(backup_buff);
+      Storage::Deallocate(backup_buff);
     } catch (...) {
       if (buffer_ != nullptr) {
         for (size_t i = 0; i < capacity_; ++i) {  // 0
           (buffer_ + i)->~T();
         }
-        operator delete(buffer_);
+        Storage::Deallocate(buffer_);
       }
       buffer_ = backup_buff;
       size_ = backup_size;
@@ -659,7 +638,7 @@ class Vector {
       buffer_ = nullptr;
       size_t i = 0;
       try {
-        buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
+        buffer_ = Storage::Allocate(capacity_);
         for (; i < size_ + 1; ++i) {  // 0
           new (buffer_ + i) T;
         }
@@ -668,7 +647,7 @@ class Vector {
           for (size_t j = i; j >= 1; --j) {
             (buffer_ + j - 1)->~T();
           }
-          operator delete(buffer_);
+          Storage::Deallocate(buffer_);
         }
         buffer_ = nullptr;
         throw;
@@ -681,13 +660,13 @@ class Vector {
       for (i = 0; i < backup_size; ++i) {
         (backup_buff + i)->~T();
       }
-      operator delete(backup_buff);
+      Storage::Deallocate(backup_buff);
     } catch (...) {
       if (buffer_ != nullptr) {
         for (size_t i = 0; i < capacity_; ++i) {  // 0
           (buffer_ + i)->~T();
         }
-        operator delete(buffer_);
+        Storage::Deallocate(buffer_);
       }
       buffer_ = backup_buff;
       size_ = backup_size;
@@ -714,7 +693,7 @@ class Vector {
       buffer_ = nullptr;
       size_t i = 0;
       try {
-        buffer_ = static_cast<T*>(operator new(sizeof(T) * capacity_));
+        buffer_ = Storage::Allocate(capacity_);
         for (; i < size_ + 1; ++i) {  // 0
           new (buffer_ + i) T;
         }
@@ -723,7 +702,7 @@ class Vector {
           for (size_t j = i; j >= 1; --j) {
             (buffer_ + j - 1)->~T();
           }
-          operator delete(buffer_);
+          Storage::Deallocate(buffer_);
         }
         buffer_ = nullptr;
         throw;
@@ -736,13 +715,13 @@ class Vector {
       for (i = 0; i < backup_size; ++i) {
         (backup_buff + i)->~T();
       }
-      operator delete(backup_buff);
+      Storage::Deallocate(backup_buff);
     } catch (...) {
       if (buffer_ != nullptr) {
         for (size_t i = 0; i < capacity_; ++i) {  // 0
           (buffer_ + i)->~T();
         }
-        operator delete(buffer_);
+        Storage::Deallocate(buffer_);
       }
       buffer_ = backup_buff;
       size_ = backup_size;
@@ -761,6 +740,7 @@ class Vector {
       }
       --size_;
       (buffer_ + size_)->~T();
+      MaybeAutoShrink();
     } catch (...) {
       buffer_ = backup_buff;
       size_ = backup_size;
@@ -769,6 +749,33 @@ class Vector {
     }
   }
 
+  // Appends [begin, end). On an exception the elements appended so far are kept.
+  template <typename InputIterator, EnableIfInputIter<InputIterator> = 0>
+  void Append(InputIterator begin, InputIterator end, size_t size_hint = 0) {
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, IteratorCategory<InputIterator>>) {
+      size_hint = static_cast<size_t>(std::distance(begin, end));
+    }
+    if (size_hint != 0) {
+      Reserve(size_ + size_hint);
+    }
+    for (; begin != end; ++begin) {
+      ConstructAtEnd(*begin);
+    }
+  }
+
+#if __cplusplus >= 202002L
+  template <std::ranges::input_range Range>
+  void AppendRange(Range&& range) {
+    if constexpr (std::ranges::sized_range<Range>) {
+      Reserve(size_ + static_cast<size_t>(std::ranges::size(range)));
+    }
+    auto last = std::ranges::end(range);
+    for (auto it = std::ranges::begin(range); it != last; ++it) {
+      ConstructAtEnd(*it);
+    }
+  }
+#endif
+
   [[nodiscard]] ConstIterator cbegin() const noexcept {  // NOLINT
     return Data();
   }
@@ -818,10 +825,68 @@ class Vector {
   }
 
  private:
+  // Moves the elements into a buffer of exactly `capacity` >= size_ slots.
+  void Reallocate(size_t capacity) {
+    T* buffer = nullptr;
+    if (capacity != 0) {
+      buffer = Storage::Allocate(capacity);
+      size_t i = 0;
+      try {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+          Storage::UninitializedCopy(buffer_, size_, buffer);
+          i = size_;
+        } else {
+          for (; i < size_; ++i) {
+            new (buffer + i) T(std::move_if_noexcept(buffer_[i]));
+          }
+        }
+      } catch (...) {
+        for (size_t j = i; j >= 1; --j) {
+          (buffer + j - 1)->~T();
+        }
+        Storage::Deallocate(buffer);
+        throw;
+      }
+    }
+    for (size_t i = 0; i < size_; ++i) {
+      (buffer_ + i)->~T();
+    }
+    Storage::Deallocate(buffer_);
+    buffer_ = buffer;
+    capacity_ = capacity;
+  }
+
+  // Shrinking is an optimization: if the smaller buffer cannot be allocated
+  // the vector simply keeps its current one.
+  void MaybeAutoShrink() noexcept {
+    if (shrink_policy_ == nullptr || shrink_policy_->low_water <= 0.0F ||
+        capacity_ <= shrink_policy_->min_capacity) {
+      return;
+    }
+    if (static_cast<double>(size_) >= static_cast<double>(capacity_) * shrink_policy_->low_water) {
+      return;
+    }
+    try {
+      TrimSlack();
+    } catch (...) {
+    }
+  }
+
+  template <typename U>
+  void ConstructAtEnd(U&& value) {
+    if (size_ == capacity_) {
+      constexpr size_t kBatch = std::max<size_t>(kAppendBatchBytes / sizeof(T), 1);
+      Reserve(std::max(capacity_ * 2, capacity_ + kBatch));
+    }
+    new (buffer_ + size_) T(std::forward<U>(value));
+    ++size_;
+  }
+
  private:
   T* buffer_{nullptr};
   size_t size_{0};
   size_t capacity_{0};
+  const ShrinkPolicy* shrink_policy_{nullptr};
 };
 
 template <typename T>
@@ -0,0 +1,321 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_VECTOR_EXPR_H_
+#define OOP_ASSIGNMENTS_VECTOR_VECTOR_EXPR_H_
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "parallel.h"
+#include "vector.h"
+
+// Lazily evaluated elementwise arithmetic over numeric Vectors. Operators on
+// Vectors, expressions and scalars build a tree of small nodes that hold
+// operands by value (Vectors by pointer) and compute nothing. Assigning the tree
+// to a Vector evaluates it in one loop that reads each operand once and
+// allocates nothing beyond the destination. The operand Vectors must outlive
+// any expression object kept in a variable.
+
+struct VectorExprBase {};
+
+template <typename E>
+class VectorExpr : public VectorExprBase {
+ public:
+  // Size of a scalar operand, which matches any vector size.
+  static constexpr size_t kBroadcast = SIZE_MAX;
+
+  template <typename T>
+  void EvaluateInto(Vector<T>& dst) const {
+    const E& expr = static_cast<const E&>(*this);
+    size_t size = expr.Size();
+    // `dst` may be one of the operands (a = a * 2), so its buffer must not move
+    // when the size already matches.
+    if (dst.Size() != size) {
+      dst.Resize(size);
+    }
+    T* out = dst.Data();
+    for (size_t i = 0; i < size; ++i) {
+      out[i] = static_cast<T>(expr[i]);
+    }
+  }
+};
+
+template <typename T>
+class VectorRef : public VectorExpr<VectorRef<T>> {
+ public:
+  using ValueType = T;
+
+  explicit VectorRef(const Vector<T>& vector) noexcept : data_(vector.Data()), size_(vector.Size()) {
+  }
+
+  [[nodiscard]] size_t Size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] T operator[](size_t idx) const noexcept {
+    return data_[idx];
+  }
+
+ private:
+  const T* data_;
+  size_t size_;
+};
+
+template <typename T>
+class ScalarExpr : public VectorExpr<ScalarExpr<T>> {
+ public:
+  using ValueType = T;
+
+  explicit ScalarExpr(T value) noexcept : value_(value) {
+  }
+
+  [[nodiscard]] size_t Size() const noexcept {
+    return VectorExpr<ScalarExpr<T>>::kBroadcast;
+  }
+
+  [[nodiscard]] T operator[](size_t) const noexcept {
+    return value_;
+  }
+
+ private:
+  T value_;
+};
+
+template <typename Operand, typename Op>
+class UnaryExpr : public VectorExpr<UnaryExpr<Operand, Op>> {
+ public:
+  using ValueType = std::decay_t<std::invoke_result_t<const Op&, typename Operand::ValueType>>;
+
+  UnaryExpr(const Operand& operand, const Op& op) : operand_(operand), op_(op) {
+  }
+
+  [[nodiscard]] size_t Size() const noexcept {
+    return operand_.Size();
+  }
+
+  [[nodiscard]] ValueType operator[](size_t idx) const {
+    return op_(operand_[idx]);
+  }
+
+ private:
+  Operand operand_;
+  Op op_;
+};
+
+template <typename Lhs, typename Rhs, typename Op>
+class BinaryExpr : public VectorExpr<BinaryExpr<Lhs, Rhs, Op>> {
+ public:
+  using ValueType =
+      std::decay_t<std::invoke_result_t<const Op&, typename Lhs::ValueType, typename Rhs::ValueType>>;
+
+  BinaryExpr(const Lhs& lhs, const Rhs& rhs, const Op& op) : lhs_(lhs), rhs_(rhs), op_(op) {
+    size_t broadcast = VectorExpr<BinaryExpr>::kBroadcast;
+    if (lhs_.Size() != rhs_.Size() && lhs_.Size() != broadcast && rhs_.Size() != broadcast) {
+      throw std::length_error("VectorExpr: operand sizes differ");
+    }
+  }
+
+  [[nodiscard]] size_t Size() const noexcept {
+    return std::min(lhs_.Size(), rhs_.Size());
+  }
+
+  [[nodiscard]] ValueType operator[](size_t idx) const {
+    return op_(lhs_[idx], rhs_[idx]);
+  }
+
+ private:
+  Lhs lhs_;
+  Rhs rhs_;
+  Op op_;
+};
+
+template <typename E>
+[[nodiscard]] E AsExpr(const VectorExpr<E>& expr) {
+  return static_cast<const E&>(expr);
+}
+
+template <typename T>
+[[nodiscard]] VectorRef<T> AsExpr(const Vector<T>& vector) noexcept {
+  return VectorRef<T>(vector);
+}
+
+template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+[[nodiscard]] ScalarExpr<T> AsExpr(T value) noexcept {
+  return ScalarExpr<T>(value);
+}
+
+template <typename T>
+struct IsNumericVector : std::false_type {};
+
+template <typename T>
+struct IsNumericVector<Vector<T>> : std::is_arithmetic<T> {};
+
+template <typename T>
+inline constexpr bool kIsVectorOperand = std::is_base_of_v<VectorExprBase, T> || IsNumericVector<T>::value;
+
+// At least one side must be a Vector or an expression, the other may be a scalar.
+template <typename Lhs, typename Rhs>
+using EnableIfVectorOperands =
+    std::enable_if_t<(kIsVectorOperand<Lhs> || kIsVectorOperand<Rhs>) &&
+                         (kIsVectorOperand<Lhs> || std::is_arithmetic_v<Lhs>) &&
+                         (kIsVectorOperand<Rhs> || std::is_arithmetic_v<Rhs>),
+                     int>;
+
+template <typename Lhs, typename Rhs, typename Op>
+[[nodiscard]] auto MakeBinaryExpr(const Lhs& lhs, const Rhs& rhs, const Op& op) {
+  auto lhs_expr = AsExpr(lhs);
+  auto rhs_expr = AsExpr(rhs);
+  return BinaryExpr<decltype(lhs_expr), decltype(rhs_expr), Op>(lhs_expr, rhs_expr, op);
+}
+
+template <typename Lhs, typename Rhs, EnableIfVectorOperands<Lhs, Rhs> = 0>
+[[nodiscard]] auto operator+(const Lhs& lhs, const Rhs& rhs) {
+  return MakeBinaryExpr(lhs, rhs, std::plus<>());
+}
+
+template <typename Lhs, typename Rhs, EnableIfVectorOperands<Lhs, Rhs> = 0>
+[[nodiscard]] auto operator-(const Lhs& lhs, const Rhs& rhs) {
+  return MakeBinaryExpr(lhs, rhs, std::minus<>());
+}
+
+template <typename Lhs, typename Rhs, EnableIfVectorOperands<Lhs, Rhs> = 0>
+[[nodiscard]] auto operator*(const Lhs& lhs, const Rhs& rhs) {
+  return MakeBinaryExpr(lhs, rhs, std::multiplies<>());
+}
+
+template <typename Lhs, typename Rhs, EnableIfVectorOperands<Lhs, Rhs> = 0>
+[[nodiscard]] auto operator/(const Lhs& lhs, const Rhs& rhs) {
+  return MakeBinaryExpr(lhs, rhs, std::divides<>());
+}
+
+template <typename Operand, typename = std::enable_if_t<kIsVectorOperand<Operand>>>
+[[nodiscard]] auto operator-(const Operand& operand) {
+  auto expr = AsExpr(operand);
+  return UnaryExpr<decltype(expr), std::negate<>>(expr, std::negate<>());
+}
+
+// Lazily applies `func` to every element, e.g. Map(a, [](float x) { return std::sqrt(x); }).
+template <typename Operand, typename Func, typename = std::enable_if_t<kIsVectorOperand<Operand>>>
+[[nodiscard]] auto Map(const Operand& operand, Func func) {
+  auto expr = AsExpr(operand);
+  return UnaryExpr<decltype(expr), Func>(expr, func);
+}
+
+template <typename E>
+[[nodiscard]] Vector<typename E::ValueType> Evaluate(const VectorExpr<E>& expr) {
+  Vector<typename E::ValueType> result;
+  expr.EvaluateInto(result);
+  return result;
+}
+
+// Evaluates `expr` into `dst`, splitting the loop across the shared pool when
+// the size reaches options.serial_cutoff.
+template <typename T, typename E>
+void Assign(Vector<T>& dst, const VectorExpr<E>& expr, const ParallelOptions& options) {
+  const E& self = static_cast<const E&>(expr);
+  if (dst.Size() != self.Size()) {
+    dst.Resize(self.Size());
+  }
+  T* out = dst.Data();
+  ParallelChunks(self.Size(), sizeof(T), options, [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      out[i] = static_cast<T>(self[i]);
+    }
+  });
+}
+
+// Reductions keep kReduceLanes independent accumulators so the loop is not
+// serialized on a single register. For floating point this fixes a summation
+// order different from a plain left-to-right loop, but the same on every run.
+inline constexpr size_t kReduceLanes = 8;
+
+template <typename E, typename Op>
+[[nodiscard]] typename E::ValueType ReduceExprRange(const E& expr, size_t begin, size_t end, Op op) {
+  using Value = typename E::ValueType;
+  if (end - begin < kReduceLanes) {
+    Value acc = expr[begin];
+    for (size_t i = begin + 1; i < end; ++i) {
+      acc = op(acc, expr[i]);
+    }
+    return acc;
+  }
+  Value lanes[kReduceLanes];
+  for (size_t k = 0; k < kReduceLanes; ++k) {
+    lanes[k] = expr[begin + k];
+  }
+  size_t i = begin + kReduceLanes;
+  for (; i + kReduceLanes <= end; i += kReduceLanes) {
+    for (size_t k = 0; k < kReduceLanes; ++k) {
+      lanes[k] = op(lanes[k], expr[i + k]);
+    }
+  }
+  for (; i < end; ++i) {
+    lanes[0] = op(lanes[0], expr[i]);
+  }
+  for (size_t k = 1; k < kReduceLanes; ++k) {
+    lanes[0] = op(lanes[0], lanes[k]);
+  }
+  return lanes[0];
+}
+
+// Combines per-chunk results in index order, so the result does not depend on
+// scheduling. Requires a non-empty expression.
+template <typename E, typename Op>
+[[nodiscard]] typename E::ValueType ReduceExpr(const E& expr, Op op, const ParallelOptions& options) {
+  using Value = typename E::ValueType;
+  size_t size = expr.Size();
+  if (size < options.serial_cutoff) {
+    return ReduceExprRange(expr, 0, size, op);
+  }
+  size_t grain = ParallelGrain(sizeof(Value), options);
+  auto partials = std::make_unique<Value[]>((size + grain - 1) / grain);
+  size_t chunks = ParallelChunks(size, sizeof(Value), options, [&](size_t chunk, size_t begin, size_t end) {
+    partials[chunk] = ReduceExprRange(expr, begin, end, op);
+  });
+  Value acc = partials[0];
+  for (size_t chunk = 1; chunk < chunks; ++chunk) {
+    acc = op(acc, partials[chunk]);
+  }
+  return acc;
+}
+
+// The default options never leave the calling thread.
+inline constexpr ParallelOptions kSerialEvaluation{0, SIZE_MAX, true};
+
+template <typename Operand, typename = std::enable_if_t<kIsVectorOperand<Operand>>>
+[[nodiscard]] auto Sum(const Operand& operand, const ParallelOptions& options = kSerialEvaluation) {
+  auto expr = AsExpr(operand);
+  using Value = typename decltype(expr)::ValueType;
+  if (expr.Size() == 0) {
+    return Value();
+  }
+  return ReduceExpr(expr, std::plus<>(), options);
+}
+
+template <typename Lhs, typename Rhs, EnableIfVectorOperands<Lhs, Rhs> = 0>
+[[nodiscard]] auto Dot(const Lhs& lhs, const Rhs& rhs, const ParallelOptions& options = kSerialEvaluation) {
+  return Sum(lhs * rhs, options);
+}
+
+template <typename Operand, typename = std::enable_if_t<kIsVectorOperand<Operand>>>
+[[nodiscard]] auto Min(const Operand& operand, const ParallelOptions& options = kSerialEvaluation) {
+  auto expr = AsExpr(operand);
+  if (expr.Size() == 0) {
+    throw std::invalid_argument("Min: empty expression");
+  }
+  using Value = typename decltype(expr)::ValueType;
+  return ReduceExpr(expr, [](const Value& a, const Value& b) { return std::min(a, b); }, options);
+}
+
+template <typename Operand, typename = std::enable_if_t<kIsVectorOperand<Operand>>>
+[[nodiscard]] auto Max(const Operand& operand, const ParallelOptions& options = kSerialEvaluation) {
+  auto expr = AsExpr(operand);
+  if (expr.Size() == 0) {
+    throw std::invalid_argument("Max: empty expression");
+  }
+  using Value = typename decltype(expr)::ValueType;
+  return ReduceExpr(expr, [](const Value& a, const Value& b) { return std::max(a, b); }, options);
+}
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_VECTOR_EXPR_H_
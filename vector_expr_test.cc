@@ -0,0 +1,34 @@
+// Regression checks for evaluating an expression into one of its own operands.
+// Build with -fsanitize=address to catch reads from a released buffer:
+//   g++ -std=c++17 -fsanitize=address -pthread vector_expr_test.cc && ./a.out
+#include <cassert>
+#include "vector_expr.h"
+
+int main() {
+  // Resize to the same size used to run the shrink policy and could move the
+  // buffer that the expression was still reading from.
+  const ShrinkPolicy policy{0.25F, 2.0F, 0};
+  Vector<float> a(10, 1.0F);
+  a.SetShrinkPolicy(&policy);
+  a.Reserve(1000);
+  a = a * 2.0F;
+  for (float value : a) {
+    assert(value == 2.0F);
+  }
+
+  Vector<float> b(10, 1.0F);
+  b.SetShrinkPolicy(&policy);
+  b.Reserve(1000);
+  Assign(b, b + b, kSerialEvaluation);
+  for (float value : b) {
+    assert(value == 2.0F);
+  }
+
+  Vector<int> c(100, 3);
+  c.SetShrinkPolicy(&policy);
+  c.Reserve(1000);
+  const int* data = c.Data();
+  c.Resize(c.Size());
+  assert(c.Data() == data);
+  return 0;
+}
@@ -0,0 +1,142 @@
+#ifndef OOP_ASSIGNMENTS_VECTOR_VECTOR_HASH_H_
+#define OOP_ASSIGNMENTS_VECTOR_VECTOR_HASH_H_
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+#include "vector.h"
+
+// 64-bit hash of a byte range in the style of xxHash64. Inputs of 32 bytes or
+// more are consumed by four independent lanes so the main loop has no
+// cross-iteration dependency between lanes and keeps several multipliers busy.
+[[nodiscard]] inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0) noexcept {
+  constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+  constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+  constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+  constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+  constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+  auto rotl = [](uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); };
+  auto load64 = [](const unsigned char* ptr) {
+    uint64_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+  };
+  auto load32 = [](const unsigned char* ptr) {
+    uint32_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+  };
+  auto round = [&](uint64_t acc, uint64_t input) { return rotl(acc + input * kPrime2, 31) * kPrime1; };
+  auto merge = [&](uint64_t acc, uint64_t lane) { return (acc ^ round(0, lane)) * kPrime1 + kPrime4; };
+
+  const auto* ptr = static_cast<const unsigned char*>(data);
+  const unsigned char* end = ptr + size;
+  uint64_t hash;
+  if (size >= 32) {
+    uint64_t lanes[4] = {seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1};
+    for (; ptr + 32 <= end; ptr += 32) {
+      for (size_t lane = 0; lane < 4; ++lane) {
+        lanes[lane] = round(lanes[lane], load64(ptr + lane * 8));
+      }
+    }
+    hash = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+    for (uint64_t lane : lanes) {
+      hash = merge(hash, lane);
+    }
+  } else {
+    hash = seed + kPrime5;
+  }
+  hash += static_cast<uint64_t>(size);
+  for (; ptr + 8 <= end; ptr += 8) {
+    hash = rotl(hash ^ round(0, load64(ptr)), 27) * kPrime1 + kPrime4;
+  }
+  if (ptr + 4 <= end) {
+    hash = rotl(hash ^ (load32(ptr) * kPrime1), 23) * kPrime2 + kPrime3;
+    ptr += 4;
+  }
+  for (; ptr < end; ++ptr) {
+    hash = rotl(hash ^ (*ptr * kPrime5), 11) * kPrime1;
+  }
+  hash ^= hash >> 33;
+  hash *= kPrime2;
+  hash ^= hash >> 29;
+  hash *= kPrime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+// Hash of the sequence [data, data + size). Types whose equal values always
+// have equal bytes are hashed as one byte range; others combine std::hash per
+// element. A Vector and a span over the same elements hash identically.
+template <typename T>
+[[nodiscard]] size_t HashElements(const T* data, size_t size) noexcept {
+  if constexpr (std::has_unique_object_representations_v<T>) {
+    return static_cast<size_t>(HashBytes(data, size * sizeof(T)));
+  } else {
+    uint64_t hash = HashBytes(&size, sizeof(size));
+    for (size_t i = 0; i < size; ++i) {
+      uint64_t element = std::hash<T>()(data[i]);
+      hash ^= element + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+    }
+    return static_cast<size_t>(HashBytes(&hash, sizeof(hash)));
+  }
+}
+
+// Transparent hasher and equality for Vector keys. Under C++20 they also accept
+// std::span<const T>, so unordered containers keyed by Vector<T> can be queried
+// with a span without building a temporary Vector.
+template <typename T>
+struct VectorHash {
+  using is_transparent = void;
+
+  [[nodiscard]] size_t operator()(const Vector<T>& value) const noexcept {
+    return HashElements(value.Data(), value.Size());
+  }
+
+#if __cplusplus >= 202002L
+  [[nodiscard]] size_t operator()(std::span<const T> value) const noexcept {
+    return HashElements(value.data(), value.size());
+  }
+#endif
+};
+
+template <typename T>
+struct VectorEqual {
+  using is_transparent = void;
+
+  [[nodiscard]] bool operator()(const Vector<T>& lhs, const Vector<T>& rhs) const noexcept {
+    return lhs == rhs;
+  }
+
+#if __cplusplus >= 202002L
+  [[nodiscard]] bool operator()(std::span<const T> lhs, const Vector<T>& rhs) const noexcept {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  [[nodiscard]] bool operator()(const Vector<T>& lhs, std::span<const T> rhs) const noexcept {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+#endif
+};
+
+template <typename Key, typename Value>
+using VectorKeyMap = std::unordered_map<Vector<Key>, Value, VectorHash<Key>, VectorEqual<Key>>;
+
+template <typename Key>
+using VectorKeySet = std::unordered_set<Vector<Key>, VectorHash<Key>, VectorEqual<Key>>;
+
+namespace std {
+template <typename T>
+struct hash<Vector<T>> {
+  [[nodiscard]] size_t operator()(const Vector<T>& value) const noexcept {
+    return HashElements(value.Data(), value.Size());
+  }
+};
+}  // namespace std
+
+#endif  // OOP_ASSIGNMENTS_VECTOR_VECTOR_HASH_H_